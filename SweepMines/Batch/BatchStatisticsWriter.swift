@@ -0,0 +1,87 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import Foundation
+
+/// Streams the statistics of generated batches to a compact columnar file.
+///
+/// The file starts with a header describing the board size, followed by one block per appended
+/// batch. All integers are little-endian.
+///
+///     header: "SMBS", version: UInt32, width: UInt32, height: UInt32, numberOfMines: UInt32
+///     block:  count: UInt32, seed: UInt64,
+///             threeBV: [UInt32; count], numberOfOpenings: [UInt32; count],
+///             isSolvable: bit-packed, (count + 7) / 8 bytes
+final class BatchStatisticsWriter {
+
+    enum Error: Swift.Error {
+        case mismatchedBoardSize
+    }
+
+    static let magic: [UInt8] = Array("SMBS".utf8)
+    static let version: UInt32 = 2
+
+    let width: Int
+    let height: Int
+    let numberOfMines: Int
+
+    private let fileHandle: FileHandle
+
+    init(url: URL, width: Int, height: Int, numberOfMines: Int) throws {
+        self.width = width
+        self.height = height
+        self.numberOfMines = numberOfMines
+
+        FileManager.default.createFile(atPath: url.path, contents: nil)
+        fileHandle = try FileHandle(forWritingTo: url)
+
+        var header = Data(Self.magic)
+        header.appendLittleEndian(Self.version)
+        header.appendLittleEndian(UInt32(width))
+        header.appendLittleEndian(UInt32(height))
+        header.appendLittleEndian(UInt32(numberOfMines))
+        try fileHandle.write(contentsOf: header)
+    }
+
+    deinit {
+        try? fileHandle.close()
+    }
+
+    func append(_ batch: MinefieldBatch) throws {
+        guard batch.width == width && batch.height == height && batch.numberOfMines == numberOfMines else {
+            throw Error.mismatchedBoardSize
+        }
+
+        var block = Data(capacity: 12 + batch.count * 8 + (batch.count + 7) / 8)
+        block.appendLittleEndian(UInt32(batch.count))
+        block.appendLittleEndian(batch.seed)
+        for value in batch.threeBV {
+            block.appendLittleEndian(value)
+        }
+        for value in batch.numberOfOpenings {
+            block.appendLittleEndian(value)
+        }
+
+        var byte: UInt8 = 0
+        for (index, isSolvable) in batch.isSolvable.enumerated() {
+            if isSolvable {
+                byte |= 1 << UInt8(index % 8)
+            }
+            if index % 8 == 7 {
+                block.append(byte)
+                byte = 0
+            }
+        }
+        if batch.count % 8 != 0 {
+            block.append(byte)
+        }
+
+        try fileHandle.write(contentsOf: block)
+    }
+
+    func close() throws {
+        try fileHandle.close()
+    }
+}
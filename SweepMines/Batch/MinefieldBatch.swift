@@ -0,0 +1,300 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import Foundation
+
+/// Generates and analyses many mine layouts of the same size at once.
+///
+/// The layouts are stored back to back in a single arena of bitboard words, and the work is
+/// split across all active processors. Every board is generated from its own generator derived
+/// from the batch seed and its index, so the results do not depend on how the work is split.
+final class MinefieldBatch {
+
+    let width: Int
+    let height: Int
+    let numberOfMines: Int
+    let count: Int
+    let seed: UInt64
+
+    /// The location every board is generated to be safe at, along with its neighbours.
+    let firstClick: Minefield.Position
+
+    private let wordsPerBoard: Int
+    private var arena: [UInt64]
+
+    private(set) var threeBV: [UInt32]
+    private(set) var numberOfOpenings: [UInt32]
+
+    /// Whether each board can be cleared from the first click without guessing, using only the
+    /// constraints of single numbers.
+    private(set) var isSolvable: [Bool]
+
+    init(width: Int, height: Int, numberOfMines: Int, count: Int, seed: UInt64, firstClick: Minefield.Position? = nil) {
+        precondition(numberOfMines < width * height, "Too many mines for the board")
+
+        self.width = width
+        self.height = height
+        self.numberOfMines = numberOfMines
+        self.count = count
+        self.seed = seed
+        self.firstClick = firstClick ?? .init(x: width / 2, y: height / 2)
+        self.wordsPerBoard = Bitboard.wordCount(width: width, height: height)
+        self.arena = Array(repeating: 0, count: wordsPerBoard * count)
+        self.threeBV = Array(repeating: 0, count: count)
+        self.numberOfOpenings = Array(repeating: 0, count: count)
+        self.isSolvable = Array(repeating: false, count: count)
+
+        generate()
+    }
+
+    /// Returns the mine layout of the board at the given index.
+    func mines(at board: Int) -> Bitboard {
+        let start = board * wordsPerBoard
+        return Bitboard(width: width, height: height, words: arena[start..<(start + wordsPerBoard)])
+    }
+
+    private func generate() {
+        #if DEBUG
+        let now = CFAbsoluteTimeGetCurrent()
+        #endif
+
+        let numberOfChunks = min(count, ProcessInfo.processInfo.activeProcessorCount * 4)
+        if numberOfChunks == 0 {
+            return
+        }
+        let boardsPerChunk = (count + numberOfChunks - 1) / numberOfChunks
+
+        arena.withUnsafeMutableBufferPointer { arena in
+            threeBV.withUnsafeMutableBufferPointer { threeBV in
+                numberOfOpenings.withUnsafeMutableBufferPointer { numberOfOpenings in
+                    isSolvable.withUnsafeMutableBufferPointer { isSolvable in
+                        DispatchQueue.concurrentPerform(iterations: numberOfChunks) { chunk in
+                            var worker = Worker(
+                                width: width,
+                                height: height,
+                                numberOfMines: numberOfMines,
+                                seed: seed,
+                                firstClick: firstClick
+                            )
+                            let start = chunk * boardsPerChunk
+                            for board in start..<min(count, start + boardsPerChunk) {
+                                worker.generate(board: board)
+
+                                let complexity = worker.analyse()
+                                threeBV[board] = UInt32(complexity.threeBV)
+                                numberOfOpenings[board] = UInt32(complexity.numberOfOpenings)
+                                isSolvable[board] = worker.solve()
+
+                                worker.mines.withUnsafeWords { words in
+                                    let offset = board * wordsPerBoard
+                                    for i in 0..<wordsPerBoard {
+                                        arena[offset + i] = words[i]
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        #if DEBUG
+        let elapsed = CFAbsoluteTimeGetCurrent() - now
+        logger.debug("\(self.count) boards generated in \(elapsed * 1000.0)ms")
+        #endif
+    }
+
+    /// Returns whether the layout can be cleared from the first click without guessing, using
+    /// the same deductions as `isSolvable`.
+    static func isSolvable(_ mines: Bitboard, firstClick: Minefield.Position) -> Bool {
+        precondition(!mines[firstClick.x, firstClick.y], "The first click must be safe")
+
+        var worker = Worker(
+            width: mines.width,
+            height: mines.height,
+            numberOfMines: mines.nonzeroBitCount,
+            seed: 0,
+            firstClick: firstClick
+        )
+        worker.load(mines)
+        return worker.solve()
+    }
+}
+
+// MARK: - Worker
+
+extension MinefieldBatch {
+
+    /// The scratch state of a single thread, reused across the boards it generates.
+    private struct Worker {
+
+        private enum State: UInt8 {
+            case covered
+            case cleared
+            case flagged
+        }
+
+        let width: Int
+        let height: Int
+        let numberOfMines: Int
+        let start: Int
+
+        /// The batch seed mixed once, so that consecutive batch seeds do not share boards.
+        private let mixedSeed: UInt64
+
+        private(set) var mines: Bitboard
+        private(set) var numberOfMinesAround: [UInt8] = []
+
+        /// The locations allowed to contain a mine, partially shuffled in place for each board.
+        private var candidates: [Int]
+        private var swaps: [Int] = []
+        private var states: [State]
+        private var stack: [Int] = []
+        private var numbers: [Int] = []
+        private var complexity: BoardComplexity.Scratch
+
+        init(width: Int, height: Int, numberOfMines: Int, seed: UInt64, firstClick: Minefield.Position) {
+            self.width = width
+            self.height = height
+            self.numberOfMines = numberOfMines
+            start = firstClick.y * width + firstClick.x
+            var mixer = SplitMix64(seed: seed)
+            mixedSeed = mixer.next()
+            mines = .init(width: width, height: height)
+            states = Array(repeating: .covered, count: width * height)
+            complexity = .init(width: width, height: height)
+
+            // Keep the first click safe, and its neighbours too when there is enough room left,
+            // matching `Minefield.placeMine(avoiding:)`.
+            let neighbours = (max(0, firstClick.y - 1)...min(height - 1, firstClick.y + 1)).flatMap { y in
+                (max(0, firstClick.x - 1)...min(width - 1, firstClick.x + 1)).map { x in y * width + x }
+            }
+            let avoidNeighbours = width * height - numberOfMines - 1 >= neighbours.count - 1
+            let avoidings = Set(avoidNeighbours ? neighbours : [start])
+            candidates = (0..<(width * height)).filter { !avoidings.contains($0) }
+        }
+
+        mutating func generate(board: Int) {
+            var mixer = SplitMix64(seed: mixedSeed ^ UInt64(board))
+            var generator = SplitMix64(seed: mixer.next())
+
+            mines.removeAll()
+            swaps.removeAll(keepingCapacity: true)
+            for k in 0..<numberOfMines {
+                let j = k + Int.random(in: 0..<(candidates.count - k), using: &generator)
+                candidates.swapAt(k, j)
+                swaps.append(j)
+                mines[candidates[k]] = true
+            }
+            // Undo the shuffle so that the layout only depends on the seed of this board.
+            for (k, j) in swaps.enumerated().reversed() {
+                candidates.swapAt(k, j)
+            }
+            mines.neighbourCounts(into: &numberOfMinesAround)
+        }
+
+        /// Uses the given layout instead of a generated one.
+        mutating func load(_ mines: Bitboard) {
+            self.mines = mines
+            mines.neighbourCounts(into: &numberOfMinesAround)
+        }
+
+        /// Computes the complexity of the generated board into the scratch buffers of the worker.
+        mutating func analyse() -> (threeBV: Int, numberOfOpenings: Int) {
+            complexity.analyse(mines: mines, numberOfMinesAround: numberOfMinesAround)
+            return (complexity.threeBV, complexity.numberOfOpenings)
+        }
+
+        /// Plays the board from the first click, clearing and flagging only the locations whose
+        /// state follows from a single number, and returns whether the whole board was cleared.
+        mutating func solve() -> Bool {
+            for i in 0..<states.count {
+                states[i] = .covered
+            }
+            numbers.removeAll(keepingCapacity: true)
+
+            var numberOfCleared = clear(start)
+            var madeProgress = true
+            while madeProgress {
+                madeProgress = false
+                var i = 0
+                while i < numbers.count {
+                    let index = numbers[i]
+                    var covered = 0
+                    var flagged = 0
+                    Self.forEachNeighbour(of: index, width: width, height: height) { neighbour in
+                        switch states[neighbour] {
+                        case .covered:
+                            covered += 1
+                        case .flagged:
+                            flagged += 1
+                        case .cleared:
+                            break
+                        }
+                    }
+
+                    // Settled numbers no longer constrain anything.
+                    if covered == 0 {
+                        numbers.swapAt(i, numbers.count - 1)
+                        numbers.removeLast()
+                        continue
+                    }
+                    i += 1
+
+                    let remaining = Int(numberOfMinesAround[index]) - flagged
+                    if remaining == 0 {
+                        Self.forEachNeighbour(of: index, width: width, height: height) { neighbour in
+                            if states[neighbour] == .covered {
+                                numberOfCleared += clear(neighbour)
+                            }
+                        }
+                        madeProgress = true
+                    } else if remaining == covered {
+                        Self.forEachNeighbour(of: index, width: width, height: height) { neighbour in
+                            if states[neighbour] == .covered {
+                                states[neighbour] = .flagged
+                            }
+                        }
+                        madeProgress = true
+                    }
+                }
+            }
+            return numberOfCleared == width * height - numberOfMines
+        }
+
+        /// Clears the location and, recursively, the openings it belongs to. Returns the number of
+        /// locations cleared.
+        private mutating func clear(_ index: Int) -> Int {
+            var numberOfCleared = 0
+            stack.append(index)
+            while let index = stack.popLast() {
+                if states[index] != .covered {
+                    continue
+                }
+                states[index] = .cleared
+                numberOfCleared += 1
+                if numberOfMinesAround[index] == 0 {
+                    Self.forEachNeighbour(of: index, width: width, height: height) { neighbour in
+                        stack.append(neighbour)
+                    }
+                } else {
+                    numbers.append(index)
+                }
+            }
+            return numberOfCleared
+        }
+
+        // Static so that the closures passed in can mutate the worker.
+        private static func forEachNeighbour(of index: Int, width: Int, height: Int, _ body: (Int) -> Void) {
+            let x = index % width
+            let y = index / width
+            for ny in max(0, y - 1)...min(height - 1, y + 1) {
+                for nx in max(0, x - 1)...min(width - 1, x + 1) where nx != x || ny != y {
+                    body(ny * width + nx)
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,293 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import Foundation
+
+/// Keeps a supply of mine layouts ready for each difficulty, so that new games start without
+/// generating a layout on the first clear.
+///
+/// Layouts are generated in the background with their safe area around the board centre, and
+/// translated under the first click by `Minefield`. Each pool is persisted to the caches
+/// directory so that it survives restarts. Custom sizes are pooled too, so only the most
+/// recently used pools are kept, both in memory and on disk.
+final class PuzzlePool {
+
+    static let shared = PuzzlePool(
+        directory: FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask)[0]
+            .appendingPathComponent("PuzzlePool", isDirectory: true)
+    )
+
+    struct Key: Hashable {
+        let width: Int
+        let height: Int
+        let numberOfMines: Int
+
+        /// Returns `nil` for boards where a 3×3 safe area does not always fit, which the
+        /// translation relies on.
+        init?(width: Int, height: Int, numberOfMines: Int) {
+            if width < 3 || height < 3 || numberOfMines > width * height - 9 {
+                return nil
+            }
+            self.width = width
+            self.height = height
+            self.numberOfMines = numberOfMines
+        }
+
+        init?(_ difficulty: DifficultyItem) {
+            self.init(width: difficulty.width, height: difficulty.height, numberOfMines: difficulty.numberOfMines)
+        }
+
+        var anchor: Minefield.Position {
+            .init(x: width / 2, y: height / 2)
+        }
+
+        fileprivate var fileName: String {
+            "\(width)x\(height)-\(numberOfMines).pool"
+        }
+    }
+
+    private static let magic: [UInt8] = Array("SMPL".utf8)
+    static let version: UInt32 = 2
+
+    private let capacity: Int = 32
+    private let refillThreshold: Int = 8
+    /// The number of pools kept in memory, and of pool files kept on disk.
+    private let maximumNumberOfPools: Int = 8
+
+    private let queue = DispatchQueue(label: "com.ktiays.SweepMines.PuzzlePool", qos: .utility)
+    private let directory: URL
+
+    private let lock: NSLock = .init()
+    // Protected by `lock`.
+    private var layouts: [Key: [Bitboard]] = [:]
+    private var preparingKeys: Set<Key> = []
+    /// The pools in memory, least recently used first.
+    private var recentKeys: [Key] = []
+
+    init(directory: URL) {
+        self.directory = directory
+    }
+
+    /// Loads the persisted pool of the difficulty and fills it in the background.
+    func prepare(for difficulty: DifficultyItem) {
+        guard let key = Key(difficulty) else {
+            return
+        }
+
+        lock.lock()
+        touch(key)
+        let needsFill = !preparingKeys.contains(key) && (layouts[key]?.count ?? 0) < refillThreshold
+        if needsFill {
+            preparingKeys.insert(key)
+        }
+        let isLoaded = layouts[key] != nil
+        lock.unlock()
+
+        if !needsFill {
+            return
+        }
+        queue.async { [self] in
+            if !isLoaded {
+                let stored = load(key)
+                lock.lock()
+                if recentKeys.contains(key) {
+                    layouts[key, default: []].append(contentsOf: stored)
+                }
+                lock.unlock()
+            }
+            fill(key)
+        }
+    }
+
+    /// Takes a ready layout for the difficulty in constant time, or returns `nil` if none is ready
+    /// yet, in which case the game generates its own layout on the first clear.
+    func takeLayout(for difficulty: DifficultyItem) -> Minefield.Layout? {
+        guard let key = Key(difficulty) else {
+            return nil
+        }
+
+        lock.lock()
+        touch(key)
+        let mines = layouts[key]?.popLast()
+        lock.unlock()
+
+        if mines != nil {
+            // Persist the removal so that the layout is not played again after a restart.
+            queue.async { [self] in
+                save(key)
+            }
+        }
+        prepare(for: difficulty)
+
+        return mines.map { .init(mines: $0, anchor: key.anchor) }
+    }
+
+    /// Marks the pool as most recently used, and evicts the least recently used pools past
+    /// `maximumNumberOfPools`. Must be called with `lock` held.
+    private func touch(_ key: Key) {
+        if let index = recentKeys.firstIndex(of: key) {
+            recentKeys.remove(at: index)
+        }
+        recentKeys.append(key)
+        while recentKeys.count > maximumNumberOfPools {
+            let evicted = recentKeys.removeFirst()
+            layouts[evicted] = nil
+            logger.info("Evicted puzzle pool \(evicted.fileName)")
+        }
+    }
+
+    // MARK: - Generation
+
+    private func fill(_ key: Key) {
+        lock.lock()
+        let missing = capacity - (layouts[key]?.count ?? 0)
+        lock.unlock()
+
+        if missing > 0 {
+            let batch = MinefieldBatch(
+                width: key.width,
+                height: key.height,
+                numberOfMines: key.numberOfMines,
+                count: missing,
+                seed: .random(in: .min ... .max),
+                firstClick: key.anchor
+            )
+            let generated = (0..<batch.count).map { batch.mines(at: $0) }
+
+            lock.lock()
+            // The pool may have been evicted while generating.
+            if recentKeys.contains(key) {
+                layouts[key, default: []].append(contentsOf: generated)
+            }
+            lock.unlock()
+        }
+
+        lock.lock()
+        preparingKeys.remove(key)
+        lock.unlock()
+
+        save(key)
+    }
+
+    // MARK: - Persistence
+
+    // A pool file is laid out as "SMPL", version: UInt32, width: UInt32, height: UInt32,
+    // numberOfMines: UInt32, count: UInt32, followed by each layout packed as width * height
+    // bits in row-major order, least significant bit first, padded to a whole byte. All
+    // integers are little-endian.
+
+    private func fileURL(for key: Key) -> URL {
+        directory.appendingPathComponent(key.fileName)
+    }
+
+    private func save(_ key: Key) {
+        lock.lock()
+        let layouts = self.layouts[key]
+        lock.unlock()
+
+        // Keep the file of an evicted pool as it was, so that it can be loaded again.
+        guard let layouts else {
+            return
+        }
+
+        do {
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+            try Self.encode(layouts, for: key).write(to: fileURL(for: key), options: .atomic)
+        } catch {
+            logger.error("Failed to save puzzle pool \(key.fileName): \(error.localizedDescription)")
+        }
+        removeStaleFiles()
+    }
+
+    /// Removes the least recently saved pool files past `maximumNumberOfPools`.
+    private func removeStaleFiles() {
+        let fileManager = FileManager.default
+        guard let urls = try? fileManager.contentsOfDirectory(at: directory, includingPropertiesForKeys: [.contentModificationDateKey]) else {
+            return
+        }
+
+        let files = urls
+            .filter { $0.pathExtension == "pool" }
+            .map { url in
+                (url, (try? url.resourceValues(forKeys: [.contentModificationDateKey]).contentModificationDate) ?? .distantPast)
+            }
+            .sorted { $0.1 > $1.1 }
+        for (url, _) in files.dropFirst(maximumNumberOfPools) {
+            try? fileManager.removeItem(at: url)
+        }
+    }
+
+    private func load(_ key: Key) -> [Bitboard] {
+        guard let data = try? Data(contentsOf: fileURL(for: key)) else {
+            return []
+        }
+        return Self.decode(data, for: key)
+    }
+
+    static func encode(_ layouts: [Bitboard], for key: Key) -> Data {
+        var data = Data(magic)
+        data.appendLittleEndian(version)
+        data.appendLittleEndian(UInt32(key.width))
+        data.appendLittleEndian(UInt32(key.height))
+        data.appendLittleEndian(UInt32(key.numberOfMines))
+        data.appendLittleEndian(UInt32(layouts.count))
+        let bytesPerLayout = (key.width * key.height + 7) / 8
+        var bytes = [UInt8](repeating: 0, count: bytesPerLayout)
+        for layout in layouts {
+            for i in 0..<bytesPerLayout {
+                bytes[i] = 0
+            }
+            layout.forEachIndex { index in
+                bytes[index / 8] |= 1 << UInt8(index % 8)
+            }
+            data.append(contentsOf: bytes)
+        }
+        return data
+    }
+
+    /// Returns the layouts stored in the data, skipping any that are truncated or have the
+    /// wrong number of mines, or none if the header does not match the key.
+    static func decode(_ data: Data, for key: Key) -> [Bitboard] {
+        var offset = magic.count
+        guard data.prefix(magic.count).elementsEqual(magic),
+            data.readLittleEndian(UInt32.self, at: &offset) == version,
+            data.readLittleEndian(UInt32.self, at: &offset) == UInt32(key.width),
+            data.readLittleEndian(UInt32.self, at: &offset) == UInt32(key.height),
+            data.readLittleEndian(UInt32.self, at: &offset) == UInt32(key.numberOfMines),
+            let count = data.readLittleEndian(UInt32.self, at: &offset)
+        else {
+            logger.error("Discarding invalid puzzle pool \(key.fileName)")
+            return []
+        }
+
+        let numberOfCells = key.width * key.height
+        let bytesPerLayout = (numberOfCells + 7) / 8
+        var layouts: [Bitboard] = []
+        for _ in 0..<count {
+            guard offset + bytesPerLayout <= data.count else {
+                logger.error("Truncated puzzle pool \(key.fileName)")
+                return layouts
+            }
+            var mines = Bitboard(width: key.width, height: key.height)
+            for (i, byte) in data[(data.startIndex + offset)..<(data.startIndex + offset + bytesPerLayout)].enumerated() {
+                var byte = byte
+                while byte != 0 {
+                    let index = i * 8 + byte.trailingZeroBitCount
+                    // Ignore stray padding bits.
+                    if index < numberOfCells {
+                        mines[index] = true
+                    }
+                    byte &= byte - 1
+                }
+            }
+            offset += bytesPerLayout
+            // Skip corrupted layouts rather than starting a game with the wrong number of mines.
+            if mines.nonzeroBitCount == key.numberOfMines {
+                layouts.append(mines)
+            }
+        }
+        return layouts
+    }
+}
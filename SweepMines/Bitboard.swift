@@ -0,0 +1,265 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import Foundation
+
+/// A row-major set of board cells, packed 64 cells per word.
+///
+/// Each row starts on a word boundary and the padding bits past `width` are always zero, so
+/// board-wide operations work on whole words instead of individual cells.
+public struct Bitboard: Equatable {
+
+    public let width: Int
+    public let height: Int
+
+    private let wordsPerRow: Int
+    private var words: [UInt64]
+
+    /// The valid bits of the last word of each row.
+    private var lastWordMask: UInt64 {
+        let remainder = width % 64
+        return remainder == 0 ? .max : (1 << UInt64(remainder)) - 1
+    }
+
+    public init(width: Int, height: Int) {
+        self.width = width
+        self.height = height
+        self.wordsPerRow = (width + 63) / 64
+        self.words = Array(repeating: 0, count: wordsPerRow * height)
+    }
+
+    /// Creates a bitboard from words in the layout produced by `withUnsafeWords(_:)`.
+    public init<C>(width: Int, height: Int, words: C) where C: Collection, C.Element == UInt64 {
+        self.width = width
+        self.height = height
+        self.wordsPerRow = (width + 63) / 64
+        self.words = Array(words)
+        precondition(self.words.count == Self.wordCount(width: width, height: height), "Invalid number of words")
+    }
+
+    /// The number of words used to store a board of the given size.
+    public static func wordCount(width: Int, height: Int) -> Int {
+        (width + 63) / 64 * height
+    }
+
+    public func withUnsafeWords<R>(_ body: (UnsafeBufferPointer<UInt64>) throws -> R) rethrows -> R {
+        try words.withUnsafeBufferPointer(body)
+    }
+
+    /// Clears every cell without releasing the storage.
+    public mutating func removeAll() {
+        for i in 0..<words.count {
+            words[i] = 0
+        }
+    }
+
+    public subscript(x: Int, y: Int) -> Bool {
+        get {
+            words[y * wordsPerRow + x / 64] & (1 << UInt64(x % 64)) != 0
+        }
+        set {
+            let index = y * wordsPerRow + x / 64
+            let bit: UInt64 = 1 << UInt64(x % 64)
+            if newValue {
+                words[index] |= bit
+            } else {
+                words[index] &= ~bit
+            }
+        }
+    }
+
+    /// Accesses the cell at the given row-major board index, i.e. `y * width + x`.
+    public subscript(index: Int) -> Bool {
+        get { self[index % width, index / width] }
+        set { self[index % width, index / width] = newValue }
+    }
+
+    public var nonzeroBitCount: Int {
+        words.reduce(0) { $0 + $1.nonzeroBitCount }
+    }
+
+    public var isEmpty: Bool {
+        words.allSatisfy { $0 == 0 }
+    }
+
+    /// Calls the given closure with the row-major board index of every set cell, in ascending order.
+    public func forEachIndex(_ body: (Int) -> Void) {
+        for y in 0..<height {
+            for i in 0..<wordsPerRow {
+                var word = words[y * wordsPerRow + i]
+                while word != 0 {
+                    let bit = word.trailingZeroBitCount
+                    body(y * width + i * 64 + bit)
+                    word &= word - 1
+                }
+            }
+        }
+    }
+
+    public static func & (lhs: Bitboard, rhs: Bitboard) -> Bitboard {
+        lhs.combined(with: rhs) { $0 & $1 }
+    }
+
+    public static func | (lhs: Bitboard, rhs: Bitboard) -> Bitboard {
+        lhs.combined(with: rhs) { $0 | $1 }
+    }
+
+    public static prefix func ~ (board: Bitboard) -> Bitboard {
+        var result = board
+        let mask = board.lastWordMask
+        for y in 0..<board.height {
+            let row = y * board.wordsPerRow
+            for i in 0..<board.wordsPerRow {
+                result.words[row + i] = ~board.words[row + i]
+            }
+            result.words[row + board.wordsPerRow - 1] &= mask
+        }
+        return result
+    }
+
+    public func subtracting(_ other: Bitboard) -> Bitboard {
+        combined(with: other) { $0 & ~$1 }
+    }
+
+    private func combined(with other: Bitboard, _ operation: (UInt64, UInt64) -> UInt64) -> Bitboard {
+        precondition(width == other.width && height == other.height, "Mismatched bitboard sizes")
+        var result = self
+        for i in 0..<words.count {
+            result.words[i] = operation(words[i], other.words[i])
+        }
+        return result
+    }
+
+    /// Returns the board moved by the given offset, wrapping around its edges.
+    public func translated(dx: Int, dy: Int) -> Bitboard {
+        var result = Bitboard(width: width, height: height)
+        forEachIndex { index in
+            let x = ((index % width + dx) % width + width) % width
+            let y = ((index / width + dy) % height + height) % height
+            result[x, y] = true
+        }
+        return result
+    }
+
+    // MARK: - Neighbourhood Kernels
+
+    /// Returns the word `i` of the row starting at `row`, shifted so that each cell holds its western neighbour.
+    @inline(__always)
+    private func westNeighbours(row: Int, word i: Int) -> UInt64 {
+        let carry = i > 0 ? words[row + i - 1] >> 63 : 0
+        return (words[row + i] << 1) | carry
+    }
+
+    /// Returns the word `i` of the row starting at `row`, shifted so that each cell holds its eastern neighbour.
+    @inline(__always)
+    private func eastNeighbours(row: Int, word i: Int) -> UInt64 {
+        let carry = i + 1 < wordsPerRow ? words[row + i + 1] << 63 : 0
+        return (words[row + i] >> 1) | carry
+    }
+
+    /// Returns the cells that are set or adjacent to a set cell.
+    public func dilated() -> Bitboard {
+        var result = Bitboard(width: width, height: height)
+        let mask = lastWordMask
+        for y in 0..<height {
+            let row = y * wordsPerRow
+            for i in 0..<wordsPerRow {
+                var word: UInt64 = 0
+                for ny in max(0, y - 1)...min(height - 1, y + 1) {
+                    let neighbourRow = ny * wordsPerRow
+                    word |= words[neighbourRow + i]
+                    word |= westNeighbours(row: neighbourRow, word: i)
+                    word |= eastNeighbours(row: neighbourRow, word: i)
+                }
+                result.words[row + i] = word
+            }
+            result.words[row + wordsPerRow - 1] &= mask
+        }
+        return result
+    }
+
+    /// Maps each bit of a byte to the lowest bit of the corresponding byte of a word.
+    private static let spreadBits: [UInt64] = (0..<256).map { byte in
+        var spread: UInt64 = 0
+        for bit in 0..<8 where byte & (1 << bit) != 0 {
+            spread |= 1 << UInt64(bit * 8)
+        }
+        return spread
+    }
+
+    /// Returns the number of set neighbours of every cell, in row-major order.
+    ///
+    /// The eight neighbour planes of each word are summed with a bit-sliced adder, so 64 cells
+    /// are counted at once, and the four bit planes of the sums are unpacked 8 cells at a time.
+    public func neighbourCounts() -> [UInt8] {
+        var counts: [UInt8] = []
+        neighbourCounts(into: &counts)
+        return counts
+    }
+
+    /// Writes the number of set neighbours of every cell into `counts`, reusing its storage.
+    public func neighbourCounts(into counts: inout [UInt8]) {
+        if counts.count != width * height {
+            counts = Array(repeating: 0, count: width * height)
+        }
+        counts.withUnsafeMutableBufferPointer { counts in
+            for y in 0..<height {
+                let row = y * wordsPerRow
+                for i in 0..<wordsPerRow {
+                    var b0: UInt64 = 0
+                    var b1: UInt64 = 0
+                    var b2: UInt64 = 0
+                    var b3: UInt64 = 0
+
+                    @inline(__always)
+                    func add(_ plane: UInt64) {
+                        let c0 = b0 & plane
+                        b0 ^= plane
+                        let c1 = b1 & c0
+                        b1 ^= c0
+                        let c2 = b2 & c1
+                        b2 ^= c1
+                        b3 |= c2
+                    }
+
+                    if y > 0 {
+                        let above = row - wordsPerRow
+                        add(words[above + i])
+                        add(westNeighbours(row: above, word: i))
+                        add(eastNeighbours(row: above, word: i))
+                    }
+                    add(westNeighbours(row: row, word: i))
+                    add(eastNeighbours(row: row, word: i))
+                    if y + 1 < height {
+                        let below = row + wordsPerRow
+                        add(words[below + i])
+                        add(westNeighbours(row: below, word: i))
+                        add(eastNeighbours(row: below, word: i))
+                    }
+
+                    let start = y * width + i * 64
+                    let numberOfCells = min(64, width - i * 64)
+                    var cell = 0
+                    while cell < numberOfCells {
+                        let shift = UInt64(cell)
+                        let bytes = Self.spreadBits[Int((b0 >> shift) & 0xFF)]
+                            | Self.spreadBits[Int((b1 >> shift) & 0xFF)] << 1
+                            | Self.spreadBits[Int((b2 >> shift) & 0xFF)] << 2
+                            | Self.spreadBits[Int((b3 >> shift) & 0xFF)] << 3
+                        if numberOfCells - cell >= 8 {
+                            UnsafeMutableRawPointer(counts.baseAddress! + start + cell)
+                                .storeBytes(of: bytes.littleEndian, as: UInt64.self)
+                        } else {
+                            for k in 0..<(numberOfCells - cell) {
+                                counts[start + cell + k] = UInt8(truncatingIfNeeded: bytes >> UInt64(k * 8))
+                            }
+                        }
+                        cell += 8
+                    }
+                }
+            }
+        }
+    }
+}
@@ -74,6 +74,14 @@ final class BoardViewController: UIViewController, ObservableObject {
     }
 
     private(set) var minefield: Minefield
+    private var engine: MinefieldEngine
+    /// Forwards the updates of the current engine, so that replacing the engine does not need
+    /// a new subscription to the controller.
+    private let engineUpdates: PassthroughSubject<MinefieldEngine.Update, Never>
+    private var engineCancellable: AnyCancellable
+    private var engineUpdatesCancellable: AnyCancellable?
+    /// Flag changes already shown on `minefield` but not yet applied by the engine.
+    private var pendingFlags: MinefieldEngine.PendingFlags = .init()
     var spacingRatio: CGFloat = 0.1 {
         didSet {
             view.setNeedsLayout()
@@ -86,6 +94,9 @@ final class BoardViewController: UIViewController, ObservableObject {
     @Published
     private(set) var remainingMines: Int = 0
 
+    @Published
+    private(set) var statistics: Minefield.Statistics = .init()
+
     #if targetEnvironment(macCatalyst)
     private let isSupportedDragInteraction: Bool = false
     #else
@@ -158,8 +169,15 @@ final class BoardViewController: UIViewController, ObservableObject {
     private let highlightedLineWidthFactor: CGFloat = 0.36
 
     init(minefield: Minefield) {
+        let engineUpdates = PassthroughSubject<MinefieldEngine.Update, Never>()
         self.minefield = minefield
+        self.engineUpdates = engineUpdates
+        (engine, engineCancellable) = Self.makeEngine(for: minefield, forwardingTo: engineUpdates)
         super.init(nibName: nil, bundle: nil)
+
+        engineUpdatesCancellable = engineUpdates.sink { [weak self] update in
+            self?.handleEngineUpdate(update)
+        }
     }
 
     required init?(coder: NSCoder) {
@@ -180,7 +198,7 @@ final class BoardViewController: UIViewController, ObservableObject {
             logger.error("Failed to create secondary click gesture recognizer")
         }
         
-        reset(with: minefield)
+        resetBoard()
     }
 
     private func forEachField(_ body: (Int, Int, Int) -> Void) {
@@ -223,9 +241,26 @@ final class BoardViewController: UIViewController, ObservableObject {
         )
     }
     
+    /// Creates an engine working on the minefield, whose updates are forwarded to `updates` until
+    /// the returned subscription is cancelled.
+    private static func makeEngine(
+        for minefield: Minefield,
+        forwardingTo updates: PassthroughSubject<MinefieldEngine.Update, Never>
+    ) -> (MinefieldEngine, AnyCancellable) {
+        let engine = MinefieldEngine(minefield: minefield)
+        return (engine, engine.updates.subscribe(updates))
+    }
+
     func reset(with minefield: Minefield) {
         self.minefield = minefield
+        (engine, engineCancellable) = Self.makeEngine(for: minefield, forwardingTo: engineUpdates)
+        pendingFlags.removeAll()
+        resetBoard()
+    }
+
+    private func resetBoard() {
         remainingMines = minefield.numberOfMines
+        statistics = minefield.statistics
         
         if let sublayers = view.layer.sublayers {
             for sublayer in sublayers {
@@ -760,28 +795,34 @@ final class BoardViewController: UIViewController, ObservableObject {
     private func handlePieceTap(layer: CALayer, at position: Minefield.Position) {
         if isGameOver { return }
 
+        // `minefield` mirrors the engine and may lag behind pending moves, which the engine
+        // treats as no-ops once they no longer apply.
         let location = minefield.location(at: position)
-        var needsUpdate = false
         if location.isCleared {
             if location.numberOfMinesAround > 0 {
-                if minefield.multiRelease(at: position) {
-                    needsUpdate = true
-                }
+                engine.enqueue(.multiRelease(position))
             }
         } else {
-            minefield.clearMine(at: position)
-            needsUpdate = true
+            engine.enqueue(.clear(position))
+        }
+    }
 
-            if gameStatus == .idle && minefield.isPlacedMines {
-                gameStatus = .playing
-            }
+    private func handleEngineUpdate(_ update: MinefieldEngine.Update) {
+        if isGameOver { return }
+
+        pendingFlags.apply(update, to: minefield)
+        remainingMines = minefield.numberOfMines - minefield.numberOfFlagged
+        statistics = minefield.statistics
+
+        if gameStatus == .idle && minefield.isPlacedMines {
+            gameStatus = .playing
         }
-        if !needsUpdate { return }
+        guard let anchor = update.anchor else { return }
 
-        updateMinesWithAnimation(anchor: position)
+        updateMinesWithAnimation(anchor: anchor, changedIndices: update.changes.locations.keys)
 
         if minefield.isExploded {
-            explode(at: position)
+            explode(at: anchor)
             gameStatus = .lose
             return
         }
@@ -796,23 +837,25 @@ final class BoardViewController: UIViewController, ObservableObject {
         lightFeedback.prepare()
     }
 
-    private func updateMinesWithAnimation(anchor: Minefield.Position) {
+    /// Uncovers the newly cleared locations among the changed ones, so that the cost of each
+    /// update does not grow with the size of the board.
+    private func updateMinesWithAnimation(anchor: Minefield.Position, changedIndices: some Sequence<Int>) {
         let anchorFrame = frame(at: anchor)
         let contentDiagonal = layoutCache.contentRect.diagonal
-        forEachField { x, y, index in
-            let position = Minefield.Position(x: x, y: y)
+        for index in changedIndices {
+            let position = Minefield.Position(x: index % minefield.width, y: index / minefield.width)
 
             let location = minefield.location(at: position)
             // If the layer has already been created, there is no need to call this function.
             let isUncovered = gridLayers[index] != nil
             if !location.isCleared || isUncovered {
-                return
+                continue
             }
 
             guard let layer = pieceLayers[index] else {
                 logger.error("Layer not found at \(position)")
                 assertionFailure()
-                return
+                continue
             }
 
             let frame = frame(at: position)
@@ -1057,13 +1100,13 @@ final class BoardViewController: UIViewController, ObservableObject {
             view.layoutIfNeeded()
         }
 
+        let targetFlag = flag ?? location.flag.next()
+        minefield.changeFlag(to: targetFlag, at: position)
+        pendingFlags.insert(targetFlag, at: position, moveID: engine.enqueue(.changeFlag(targetFlag, position)))
         if let flag {
-            minefield.changeFlag(to: flag, at: position)
             flagLayer.changeFlag(to: flag, with: flag == .maybe ? .top : .bottom)
         } else {
-            let next = location.flag.next()
-            minefield.changeFlag(to: next, at: position)
-            flagLayer.changeFlag(to: next)
+            flagLayer.changeFlag(to: targetFlag)
         }
         
         remainingMines = minefield.numberOfMines - minefield.numberOfFlagged
@@ -0,0 +1,175 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import Foundation
+
+/// Complexity metrics of a mine layout.
+///
+/// An opening is a connected region of locations without mines around, which is cleared by a
+/// single click together with its numbered border. The 3BV of a board is the minimum number of
+/// clicks needed to clear it: one per opening, plus one per numbered location outside every
+/// opening.
+public struct BoardComplexity: Equatable {
+
+    public let threeBV: Int
+    public let numberOfOpenings: Int
+
+    /// The index of the opening each location belongs to, or -1 for locations with mines around.
+    public let openings: [Int32]
+
+    /// The numbered locations outside every opening, each of which takes a click of its own.
+    public let isolatedNumbers: Bitboard
+
+    /// Computes the metrics of a layout with a union-find over its openings.
+    ///
+    /// - Parameters:
+    ///   - mines: The locations containing a mine.
+    ///   - numberOfMinesAround: The number of mines around each location, in row-major order.
+    public init(mines: Bitboard, numberOfMinesAround: [UInt8]) {
+        var scratch = Scratch(width: mines.width, height: mines.height)
+        scratch.analyse(mines: mines, numberOfMinesAround: numberOfMinesAround)
+        self.threeBV = scratch.threeBV
+        self.numberOfOpenings = scratch.numberOfOpenings
+        self.openings = scratch.labels
+        self.isolatedNumbers = scratch.isolatedNumbers
+    }
+}
+
+extension BoardComplexity {
+
+    /// The buffers used to compute the metrics, which can be reused across layouts of the same
+    /// size to avoid allocating for each of them.
+    struct Scratch {
+
+        /// The neighbours visited before a location in row-major order.
+        private static let earlierNeighbours: [(dx: Int, dy: Int)] = [(-1, -1), (0, -1), (1, -1), (-1, 0)]
+
+        let width: Int
+        let height: Int
+
+        private(set) var threeBV: Int = 0
+        private(set) var numberOfOpenings: Int = 0
+        private(set) var labels: [Int32]
+        private(set) var isolatedNumbers: Bitboard
+
+        private var openings: UnionFind
+
+        init(width: Int, height: Int) {
+            self.width = width
+            self.height = height
+            labels = Array(repeating: -1, count: width * height)
+            isolatedNumbers = .init(width: width, height: height)
+            openings = .init(count: width * height)
+        }
+
+        mutating func analyse(mines: Bitboard, numberOfMinesAround: [UInt8]) {
+            precondition(mines.width == width && mines.height == height, "Mismatched board size")
+
+            openings.reset()
+            for y in 0..<height {
+                for x in 0..<width {
+                    let index = y * width + x
+                    if mines[x, y] || numberOfMinesAround[index] != 0 {
+                        continue
+                    }
+                    // Union with the neighbours already visited.
+                    for (dx, dy) in Self.earlierNeighbours {
+                        let nx = x + dx
+                        let ny = y + dy
+                        if nx < 0 || nx >= width || ny < 0 {
+                            continue
+                        }
+                        let neighbour = ny * width + nx
+                        if !mines[nx, ny] && numberOfMinesAround[neighbour] == 0 {
+                            openings.union(index, neighbour)
+                        }
+                    }
+                }
+            }
+
+            numberOfOpenings = 0
+            for i in 0..<labels.count {
+                labels[i] = -1
+            }
+            isolatedNumbers.removeAll()
+            for y in 0..<height {
+                for x in 0..<width {
+                    let index = y * width + x
+                    if mines[x, y] {
+                        continue
+                    }
+                    if numberOfMinesAround[index] == 0 {
+                        // Label the opening through its root the first time any of its locations is visited.
+                        let root = openings.find(index)
+                        if labels[root] < 0 {
+                            labels[root] = Int32(numberOfOpenings)
+                            numberOfOpenings += 1
+                        }
+                        labels[index] = labels[root]
+                        continue
+                    }
+
+                    var isBorder = false
+                    for ny in max(0, y - 1)...min(height - 1, y + 1) where !isBorder {
+                        for nx in max(0, x - 1)...min(width - 1, x + 1) {
+                            if !mines[nx, ny] && numberOfMinesAround[ny * width + nx] == 0 {
+                                isBorder = true
+                                break
+                            }
+                        }
+                    }
+                    if !isBorder {
+                        isolatedNumbers[x, y] = true
+                    }
+                }
+            }
+
+            threeBV = numberOfOpenings + isolatedNumbers.nonzeroBitCount
+        }
+    }
+}
+
+/// A disjoint-set forest with path halving and union by size.
+struct UnionFind {
+
+    private var parents: [Int32]
+    private var sizes: [Int32]
+
+    init(count: Int) {
+        parents = (0..<Int32(count)).map { $0 }
+        sizes = Array(repeating: 1, count: count)
+    }
+
+    /// Puts every element back in a set of its own, keeping the storage.
+    mutating func reset() {
+        for i in 0..<parents.count {
+            parents[i] = Int32(i)
+            sizes[i] = 1
+        }
+    }
+
+    mutating func find(_ element: Int) -> Int {
+        var element = Int32(element)
+        while parents[Int(element)] != element {
+            let parent = parents[Int(element)]
+            parents[Int(element)] = parents[Int(parent)]
+            element = parent
+        }
+        return Int(element)
+    }
+
+    mutating func union(_ a: Int, _ b: Int) {
+        var a = find(a)
+        var b = find(b)
+        if a == b {
+            return
+        }
+        if sizes[a] < sizes[b] {
+            swap(&a, &b)
+        }
+        parents[b] = Int32(a)
+        sizes[a] += sizes[b]
+    }
+}
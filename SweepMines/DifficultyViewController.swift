@@ -13,6 +13,10 @@ final class DifficultyViewController: UIViewController {
 
         view.backgroundColor = .boardBackground
 
+        for difficulty in configureDifficulties().values {
+            PuzzlePool.shared.prepare(for: difficulty)
+        }
+
         let difficultyView = _UIHostingView(
             rootView: DifficultySelectionView(difficultyDidSelect: { [weak self] item in
                 if item.id == .custom {
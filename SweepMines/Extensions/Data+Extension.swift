@@ -0,0 +1,30 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import Foundation
+
+extension Data {
+
+    mutating func appendLittleEndian<T>(_ value: T) where T: FixedWidthInteger {
+        withUnsafeBytes(of: value.littleEndian) { bytes in
+            append(contentsOf: bytes)
+        }
+    }
+
+    /// Reads a little-endian integer at the given offset from the start of the data, advancing the
+    /// offset past it. Returns `nil` if the data is too short.
+    func readLittleEndian<T>(_ type: T.Type = T.self, at offset: inout Int) -> T? where T: FixedWidthInteger {
+        let size = MemoryLayout<T>.size
+        if offset + size > count {
+            return nil
+        }
+        var value: T = 0
+        Swift.withUnsafeMutableBytes(of: &value) { buffer in
+            buffer.copyBytes(from: self[(startIndex + offset)..<(startIndex + offset + size)])
+        }
+        offset += size
+        return T(littleEndian: value)
+    }
+}
@@ -33,7 +33,7 @@ final class GameViewController: UIViewController {
 
     init(difficulty: DifficultyItem) {
         self.difficulty = difficulty
-        minefield = .init(width: difficulty.width, height: difficulty.height, numberOfMines: difficulty.numberOfMines)
+        minefield = Self.makeMinefield(for: difficulty)
         super.init(nibName: nil, bundle: nil)
         self.modalPresentationStyle = .fullScreen
         self.transitioningDelegate = self
@@ -43,6 +43,15 @@ final class GameViewController: UIViewController {
         fatalError("init(coder:) has not been implemented")
     }
 
+    private static func makeMinefield(for difficulty: DifficultyItem) -> Minefield {
+        .init(
+            width: difficulty.width,
+            height: difficulty.height,
+            numberOfMines: difficulty.numberOfMines,
+            layout: PuzzlePool.shared.takeLayout(for: difficulty)
+        )
+    }
+
     override func viewDidLoad() {
         super.viewDidLoad()
 
@@ -213,7 +222,7 @@ final class GameViewController: UIViewController {
 
     private func handleReplay(_ actionContext: ReplayButton.ActionContext) {
         func restartGame() {
-            minefield = .init(width: difficulty.width, height: difficulty.height, numberOfMines: difficulty.numberOfMines)
+            minefield = Self.makeMinefield(for: difficulty)
             boardViewController.reset(with: minefield)
         }
         if boardViewController!.gameStatus == .playing {
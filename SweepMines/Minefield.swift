@@ -67,10 +67,70 @@ public final class Minefield {
         width * height
     }
 
+    /// A mine layout generated ahead of time.
+    ///
+    /// The locations around `anchor` contain no mines. On the first clear the layout is translated
+    /// so that the anchor lands on the cleared location.
+    public struct Layout {
+        public var mines: Bitboard
+        public var anchor: Position
+
+        public init(mines: Bitboard, anchor: Position) {
+            self.mines = mines
+            self.anchor = anchor
+        }
+    }
+
+    /// Live efficiency statistics of a game.
+    public struct Statistics: Equatable {
+        /// The minimum number of clicks needed to clear the board, known once mines are placed.
+        public var threeBV: Int = 0
+        /// The part of `threeBV` already cleared.
+        public var solvedThreeBV: Int = 0
+        /// The number of clears, chords and flag changes made so far. Every clear and chord counts
+        /// while the game is running, even when it changes nothing.
+        public var numberOfClicks: Int = 0
+
+        /// The 3BV cleared per click so far.
+        public var efficiency: Double {
+            numberOfClicks > 0 ? Double(solvedThreeBV) / Double(numberOfClicks) : 0
+        }
+
+        public func threeBVPerSecond(elapsed: TimeInterval) -> Double {
+            elapsed > 0 ? Double(solvedThreeBV) / elapsed : 0
+        }
+    }
+
+    /// A set of location updates produced by one or more moves.
+    ///
+    /// Change sets are produced by `takeChanges()` on the minefield that performs the moves, and
+    /// applied to mirror instances with `apply(_:)`.
+    public struct ChangeSet {
+        public var locations: [Int: Location] = [:]
+
+        /// The mines and the number of mines around every location, set only by the change set
+        /// that places the mines instead of listing every location in `locations`.
+        public var placedMines: (mines: Bitboard, numberOfMinesAround: [UInt8])?
+
+        public var numberOfCleared: Int = 0
+        public var numberOfFlagged: Int = 0
+        public var isPlacedMines: Bool = false
+        public var isExploded: Bool = false
+        public var isCompleted: Bool = false
+        public var statistics: Statistics = .init()
+
+        public var isEmpty: Bool {
+            locations.isEmpty && placedMines == nil
+        }
+    }
+
     public var autoFlag: Bool = false
 
     public private(set) var locations: [Location]
 
+    /// The layout used instead of a random one when mines are placed.
+    private let preparedLayout: Layout?
+
     private(set) var numberOfCleared: Int = 0
     private(set) var numberOfFlagged: Int = 0
     private(set) var isPlacedMines: Bool = false
@@ -79,11 +139,111 @@ public final class Minefield {
 
     public private(set) var isCompleted: Bool = false
 
-    public init(width: Int, height: Int, numberOfMines: Int) {
+    private var mineCells: Bitboard
+    private var flaggedCells: Bitboard
+
+    /// The covered locations adjacent to at least one cleared location.
+    ///
+    /// The cleared locations are gathered from `locations` on demand, so clearing does not have
+    /// to keep another bitboard up to date.
+    public var frontier: Bitboard {
+        var clearedCells = Bitboard(width: width, height: height)
+        for y in 0..<height {
+            for x in 0..<width where locations[y * width + x].isCleared {
+                clearedCells[x, y] = true
+            }
+        }
+        return clearedCells.dilated().subtracting(clearedCells)
+    }
+
+    /// The mines that have not been flagged yet.
+    public var unflaggedMines: Bitboard {
+        mineCells.subtracting(flaggedCells)
+    }
+
+    public private(set) var statistics: Statistics = .init()
+
+    private var complexity: BoardComplexity?
+    private var isOpeningCleared: [Bool] = []
+
+    /// Indices of the locations modified since the last call to `takeChanges()`.
+    private var changedIndices: IndexSet = .init()
+    /// The mines placed since the last call to `takeChanges()`, which changes every location.
+    private var placedMines: (mines: Bitboard, numberOfMinesAround: [UInt8])?
+
+    public init(width: Int, height: Int, numberOfMines: Int, layout: Layout? = nil) {
         self.width = width
         self.height = height
         self.numberOfMines = numberOfMines
+        if let layout {
+            precondition(layout.mines.width == width && layout.mines.height == height, "Mismatched layout size")
+        }
+        self.preparedLayout = layout
         self.locations = Array(repeating: Location(), count: width * height)
+        self.mineCells = .init(width: width, height: height)
+        self.flaggedCells = .init(width: width, height: height)
+    }
+
+    /// Returns a new minefield with the same configuration and state as this one.
+    public func copy() -> Minefield {
+        let minefield = Minefield(width: width, height: height, numberOfMines: numberOfMines, layout: preparedLayout)
+        minefield.autoFlag = autoFlag
+        minefield.locations = locations
+        minefield.mineCells = mineCells
+        minefield.flaggedCells = flaggedCells
+        minefield.numberOfCleared = numberOfCleared
+        minefield.numberOfFlagged = numberOfFlagged
+        minefield.isPlacedMines = isPlacedMines
+        minefield.isExploded = isExploded
+        minefield.isCompleted = isCompleted
+        minefield.statistics = statistics
+        minefield.complexity = complexity
+        minefield.isOpeningCleared = isOpeningCleared
+        return minefield
+    }
+
+    /// Returns the locations modified since the last call, along with the current game state.
+    public func takeChanges() -> ChangeSet {
+        var changes = ChangeSet()
+        changes.placedMines = placedMines
+        for index in changedIndices {
+            changes.locations[index] = locations[index]
+        }
+        changes.numberOfCleared = numberOfCleared
+        changes.numberOfFlagged = numberOfFlagged
+        changes.isPlacedMines = isPlacedMines
+        changes.isExploded = isExploded
+        changes.isCompleted = isCompleted
+        changes.statistics = statistics
+        changedIndices.removeAll()
+        placedMines = nil
+        return changes
+    }
+
+    /// Applies a change set produced by another minefield of the same size.
+    public func apply(_ changes: ChangeSet) {
+        if let placedMines = changes.placedMines {
+            for (index, numberOfMinesAround) in placedMines.numberOfMinesAround.enumerated() {
+                locations[index].numberOfMinesAround = Int(numberOfMinesAround)
+            }
+            placedMines.mines.forEachIndex { index in
+                locations[index].hasMine = true
+            }
+            mineCells = placedMines.mines
+        }
+        for (index, location) in changes.locations {
+            locations[index] = location
+            let x = index % width
+            let y = index / width
+            mineCells[x, y] = location.hasMine
+            flaggedCells[x, y] = location.flag == .flag
+        }
+        numberOfCleared = changes.numberOfCleared
+        numberOfFlagged = changes.numberOfFlagged
+        isPlacedMines = changes.isPlacedMines
+        isExploded = changes.isExploded
+        isCompleted = changes.isCompleted
+        statistics = changes.statistics
     }
 
     public func hasMineAt(x: Int, y: Int) -> Bool {
@@ -109,13 +269,26 @@ public final class Minefield {
             return
         }
 
+        statistics.numberOfClicks += 1
+        setFlag(flag, at: position)
+    }
+
+    private func setFlag(_ flag: Flag, at position: Position) {
+        let location = location(at: position)
+        if location.isCleared || location.flag == flag {
+            return
+        }
+
         if flag == .flag {
             numberOfFlagged += 1
         } else if location.flag == .flag {
             numberOfFlagged -= 1
         }
 
-        locations[position.y * width + position.x].flag = flag
+        let index = position.y * width + position.x
+        locations[index].flag = flag
+        flaggedCells[position.x, position.y] = flag == .flag
+        changedIndices.insert(index)
     }
 
     public func neighbour(of position: Position) -> [Position] {
@@ -141,6 +314,38 @@ public final class Minefield {
         let now = CACurrentMediaTime()
         #endif
 
+        let mineCells: Bitboard
+        if let layout = preparedLayout {
+            // Move the safe area around the anchor under the first click.
+            mineCells = layout.mines.translated(dx: position.x - layout.anchor.x, dy: position.y - layout.anchor.y)
+        } else {
+            mineCells = randomMines(avoiding: position)
+        }
+
+        let neighbourCounts = mineCells.neighbourCounts()
+        var locations = self.locations
+        for (index, numberOfMinesAround) in neighbourCounts.enumerated() {
+            locations[index].numberOfMinesAround = Int(numberOfMinesAround)
+        }
+        mineCells.forEachIndex { index in
+            locations[index].hasMine = true
+        }
+        self.mineCells = mineCells
+        self.locations = locations
+        placedMines = (mineCells, neighbourCounts)
+
+        let complexity = BoardComplexity(mines: mineCells, numberOfMinesAround: neighbourCounts)
+        self.complexity = complexity
+        isOpeningCleared = Array(repeating: false, count: complexity.numberOfOpenings)
+        statistics.threeBV = complexity.threeBV
+
+        #if DEBUG
+        let elapsed = CACurrentMediaTime() - now
+        logger.debug("\(self.numberOfMines) Mines placed in \(elapsed * 1000.0)ms")
+        #endif
+    }
+
+    private func randomMines(avoiding position: Position) -> Bitboard {
         let neighbours = self.neighbour(of: position)
 
         var mines: [Bool] = Array(repeating: true, count: numberOfMines)
@@ -156,26 +361,20 @@ public final class Minefield {
             mines.insert(false, at: i)
         }
 
-        var locations = self.locations
-        for (index, hasMine) in mines.enumerated() {
-            locations[index].hasMine = hasMine
-            if hasMine {
-                for neighbour in self.neighbour(of: Position(x: index % width, y: index / width)) {
-                    let i = neighbour.y * width + neighbour.x
-                    locations[i].numberOfMinesAround += 1
-                }
-            }
+        var mineCells = Bitboard(width: width, height: height)
+        for (index, hasMine) in mines.enumerated() where hasMine {
+            mineCells[index] = true
         }
-        self.locations = locations
-
-        #if DEBUG
-        let elapsed = CACurrentMediaTime() - now
-        logger.debug("\(self.numberOfMines) Mines placed in \(elapsed * 1000.0)ms")
-        #endif
+        return mineCells
     }
 
     @discardableResult
     public func multiRelease(at position: Position) -> Bool {
+        if isExploded || isCompleted {
+            return false
+        }
+        statistics.numberOfClicks += 1
+
         let location = self.location(at: position)
 
         var flags = 0
@@ -203,9 +402,9 @@ public final class Minefield {
         for neighbour in self.neighbour(of: position) {
             let flag = flagAt(x: neighbour.x, y: neighbour.y)
             if doClear && flag != .flag {
-                clearMine(at: neighbour)
+                clear(at: neighbour)
             } else {
-                changeFlag(to: .flag, at: neighbour)
+                setFlag(.flag, at: neighbour)
             }
         }
         return doClear
@@ -215,7 +414,16 @@ public final class Minefield {
         if isExploded || isCompleted {
             return
         }
-        
+
+        statistics.numberOfClicks += 1
+        clear(at: position)
+    }
+
+    private func clear(at position: Position) {
+        if isExploded || isCompleted {
+            return
+        }
+
         let location = location(at: position)
         if location.isCleared || location.flag == .flag {
             return
@@ -244,11 +452,11 @@ public final class Minefield {
         let isCompleted = numberOfCleared == width * height - numberOfMines
         if isCompleted {
             logger.info("Game completed")
-            for (index, location) in locations.enumerated() {
-                if location.hasMine && location.flag != .flag {
-                    locations[index].flag = .flag
-                }
+            unflaggedMines.forEachIndex { index in
+                locations[index].flag = .flag
+                changedIndices.insert(index)
             }
+            flaggedCells = flaggedCells | mineCells
             self.isCompleted = true
         }
         self.locations = locations
@@ -263,11 +471,14 @@ public final class Minefield {
         }
 
         locations[index].isCleared = true
+        changedIndices.insert(index)
         numberOfCleared += 1
         if location.flag == .flag {
             numberOfFlagged -= 1
+            flaggedCells[position.x, position.y] = false
         }
         locations[index].flag = .none
+        updateSolvedThreeBV(clearing: index)
 
         // Automatically clear locations around if no mines around.
         if location.numberOfMinesAround == 0 {
@@ -276,4 +487,22 @@ public final class Minefield {
             }
         }
     }
+
+    /// Counts the 3BV solved by clearing the location: the first cleared location of an opening
+    /// solves the whole opening, and an isolated number solves itself.
+    private func updateSolvedThreeBV(clearing index: Int) {
+        guard let complexity else {
+            return
+        }
+
+        let opening = Int(complexity.openings[index])
+        if opening >= 0 {
+            if !isOpeningCleared[opening] {
+                isOpeningCleared[opening] = true
+                statistics.solvedThreeBV += 1
+            }
+        } else if complexity.isolatedNumbers[index] {
+            statistics.solvedThreeBV += 1
+        }
+    }
 }
@@ -0,0 +1,147 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import Combine
+import Foundation
+
+/// Runs the moves of a game on a dedicated serial queue.
+///
+/// Moves enqueued while the engine is busy are coalesced into a single batch, applied in order
+/// without dropping any, so the result never depends on how moves were batched. The changes
+/// produced by each batch are published back on the delivery queue. Every batch is published,
+/// even when it changed nothing, so that callers can tell which of their moves have been applied.
+final class MinefieldEngine {
+
+    enum Move: Hashable {
+        case clear(Minefield.Position)
+        case multiRelease(Minefield.Position)
+        case changeFlag(Minefield.Flag, Minefield.Position)
+    }
+
+    /// Identifies an enqueued move. Identifiers increase in the order moves are enqueued.
+    typealias MoveID = UInt64
+
+    struct Update {
+        /// The identifier of the last move applied by this update.
+        let lastMoveID: MoveID
+        /// The position of the last move in the batch that changed the board.
+        let anchor: Minefield.Position?
+        let changes: Minefield.ChangeSet
+    }
+
+    var updates: AnyPublisher<Update, Never> {
+        subject.eraseToAnyPublisher()
+    }
+
+    // Only accessed on `queue`.
+    private let minefield: Minefield
+
+    private let queue: DispatchQueue
+    private let deliveryQueue: DispatchQueue
+    private let subject: PassthroughSubject<Update, Never> = .init()
+
+    private let lock: NSLock = .init()
+    // Protected by `lock`.
+    private var pendingMoves: [(id: MoveID, move: Move)] = []
+    private var lastMoveID: MoveID = 0
+    private var isDrainScheduled: Bool = false
+
+    /// Creates an engine working on a copy of the given minefield.
+    init(minefield: Minefield, deliveryQueue: DispatchQueue = .main) {
+        self.minefield = minefield.copy()
+        self.queue = DispatchQueue(label: "com.ktiays.SweepMines.MinefieldEngine", qos: .userInitiated)
+        self.deliveryQueue = deliveryQueue
+    }
+
+    @discardableResult
+    func enqueue(_ move: Move) -> MoveID {
+        lock.lock()
+        defer { lock.unlock() }
+
+        lastMoveID += 1
+        pendingMoves.append((lastMoveID, move))
+
+        if !isDrainScheduled {
+            isDrainScheduled = true
+            queue.async { [self] in
+                drain()
+            }
+        }
+        return lastMoveID
+    }
+
+    private func drain() {
+        lock.lock()
+        let moves = pendingMoves
+        pendingMoves.removeAll(keepingCapacity: true)
+        isDrainScheduled = false
+        lock.unlock()
+
+        var anchor: Minefield.Position?
+        for (_, move) in moves {
+            let numberOfCleared = minefield.numberOfCleared
+            let isExploded = minefield.isExploded
+            switch move {
+            case .clear(let position):
+                minefield.clearMine(at: position)
+                if minefield.numberOfCleared != numberOfCleared || minefield.isExploded != isExploded {
+                    anchor = position
+                }
+            case .multiRelease(let position):
+                minefield.multiRelease(at: position)
+                if minefield.numberOfCleared != numberOfCleared || minefield.isExploded != isExploded {
+                    anchor = position
+                }
+            case .changeFlag(let flag, let position):
+                minefield.changeFlag(to: flag, at: position)
+            }
+        }
+
+        guard let lastMoveID = moves.last?.id else {
+            return
+        }
+        let update = Update(lastMoveID: lastMoveID, anchor: anchor, changes: minefield.takeChanges())
+        deliveryQueue.async { [subject] in
+            subject.send(update)
+        }
+    }
+}
+
+// MARK: - Pending Flags
+
+extension MinefieldEngine {
+
+    /// Flag changes already shown on a mirror of the engine's minefield but not yet applied by
+    /// the engine.
+    ///
+    /// A change set predates the flag changes still queued behind it, so applying it alone would
+    /// revert those flags on the mirror. `apply(_:to:)` puts them back on top.
+    struct PendingFlags {
+
+        private var flags: [Minefield.Position: (flag: Minefield.Flag, moveID: MoveID)] = [:]
+
+        var isEmpty: Bool {
+            flags.isEmpty
+        }
+
+        /// Records a flag change shown on the mirror and enqueued as the move `moveID`.
+        mutating func insert(_ flag: Minefield.Flag, at position: Minefield.Position, moveID: MoveID) {
+            flags[position] = (flag, moveID)
+        }
+
+        mutating func removeAll() {
+            flags.removeAll()
+        }
+
+        /// Applies the update to the mirror, then puts back the flag changes it does not cover yet.
+        mutating func apply(_ update: Update, to mirror: Minefield) {
+            mirror.apply(update.changes)
+            flags = flags.filter { $0.value.moveID > update.lastMoveID }
+            for (position, pending) in flags {
+                mirror.changeFlag(to: pending.flag, at: position)
+            }
+        }
+    }
+}
@@ -0,0 +1,184 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import XCTest
+
+@testable import SweepMines
+
+final class BitboardTests: XCTestCase {
+
+    /// Widths around word boundaries, where the carries between words matter.
+    private let widths = [1, 2, 63, 64, 65, 127, 128, 129]
+
+    private func makeBitboard(width: Int, height: Int, density: Double, seed: UInt64) -> (Bitboard, [Bool]) {
+        var generator = SplitMix64(seed: seed)
+        var board = Bitboard(width: width, height: height)
+        var cells = Array(repeating: false, count: width * height)
+        for index in 0..<cells.count where Double.random(in: 0..<1, using: &generator) < density {
+            board[index] = true
+            cells[index] = true
+        }
+        return (board, cells)
+    }
+
+    /// Counts the set neighbours of every cell one cell at a time.
+    private func scalarNeighbourCounts(_ cells: [Bool], width: Int, height: Int) -> [UInt8] {
+        var counts: [UInt8] = Array(repeating: 0, count: width * height)
+        for y in 0..<height {
+            for x in 0..<width {
+                var count: UInt8 = 0
+                for ny in max(0, y - 1)...min(height - 1, y + 1) {
+                    for nx in max(0, x - 1)...min(width - 1, x + 1) where (nx != x || ny != y) && cells[ny * width + nx] {
+                        count += 1
+                    }
+                }
+                counts[y * width + x] = count
+            }
+        }
+        return counts
+    }
+
+    func testNeighbourCountsMatchBruteForce() {
+        for width in widths {
+            for height in [1, 2, 3, 17] {
+                for (seed, density) in [0.0, 0.2, 0.5, 1.0].enumerated() {
+                    let (board, cells) = makeBitboard(width: width, height: height, density: density, seed: UInt64(seed))
+                    XCTAssertEqual(
+                        board.neighbourCounts(),
+                        scalarNeighbourCounts(cells, width: width, height: height),
+                        "\(width)×\(height), density \(density)"
+                    )
+                }
+            }
+        }
+    }
+
+    func testNeighbourCountsReuseStorage() {
+        var counts: [UInt8] = []
+        for width in widths {
+            let (board, cells) = makeBitboard(width: width, height: 9, density: 0.4, seed: UInt64(width) &+ 3)
+            board.neighbourCounts(into: &counts)
+            XCTAssertEqual(counts, scalarNeighbourCounts(cells, width: width, height: 9), "width \(width)")
+        }
+    }
+
+    /// Returns the cells that are set or have a set neighbour, one cell at a time.
+    private func scalarDilation(_ cells: [Bool], width: Int, height: Int) -> [Bool] {
+        (0..<(width * height)).map { index in
+            let x = index % width
+            let y = index / width
+            for ny in max(0, y - 1)...min(height - 1, y + 1) {
+                for nx in max(0, x - 1)...min(width - 1, x + 1) where cells[ny * width + nx] {
+                    return true
+                }
+            }
+            return false
+        }
+    }
+
+    func testDilationMatchesBruteForce() {
+        for width in widths {
+            for height in [1, 2, 3, 17] {
+                for (seed, density) in [0.0, 0.05, 0.3, 1.0].enumerated() {
+                    let (board, cells) = makeBitboard(width: width, height: height, density: density, seed: UInt64(seed) &+ 10)
+                    let dilated = board.dilated()
+                    let expected = scalarDilation(cells, width: width, height: height)
+                    XCTAssertEqual(dilated.nonzeroBitCount, expected.filter { $0 }.count, "\(width)×\(height), density \(density)")
+                    for index in 0..<(width * height) {
+                        XCTAssertEqual(dilated[index], expected[index], "\(width)×\(height) at \(index)")
+                    }
+                }
+            }
+        }
+    }
+
+    func testFrontierMatchesBruteForce() {
+        for width in [63, 64, 65, 127, 128, 129] {
+            let height = 12
+            let numberOfMines = width * height / 8
+            let minefield = Minefield(
+                width: width,
+                height: height,
+                numberOfMines: numberOfMines,
+                layout: makeLayout(width: width, height: height, numberOfMines: numberOfMines, seed: UInt64(width))
+            )
+            let moves = makeMoves(width: width, height: height, count: 20, seed: UInt64(width))
+            minefield.clearMine(at: .init(x: width / 2, y: height / 2))
+            replay(moves.filter { if case .changeFlag = $0 { return false } else { return true } }, on: minefield)
+
+            let cleared = minefield.locations.map(\.isCleared)
+            let dilated = scalarDilation(cleared, width: width, height: height)
+            let frontier = minefield.frontier
+            for index in 0..<(width * height) {
+                XCTAssertEqual(frontier[index], dilated[index] && !cleared[index], "width \(width) at \(index)")
+            }
+        }
+    }
+
+    func testComplementKeepsPaddingClear() {
+        for width in widths {
+            let (board, cells) = makeBitboard(width: width, height: 5, density: 0.3, seed: UInt64(width))
+            let complement = ~board
+            XCTAssertEqual(complement.nonzeroBitCount, cells.filter { !$0 }.count, "width \(width)")
+            XCTAssertEqual((~complement), board, "width \(width)")
+            XCTAssertTrue((board & complement).isEmpty, "width \(width)")
+            XCTAssertEqual(board.subtracting(board), Bitboard(width: width, height: 5))
+        }
+    }
+
+    func testForEachIndexVisitsSetCellsInOrder() {
+        for width in widths {
+            let (board, cells) = makeBitboard(width: width, height: 7, density: 0.3, seed: UInt64(width) &+ 1)
+            var indices: [Int] = []
+            board.forEachIndex { indices.append($0) }
+            XCTAssertEqual(indices, cells.indices.filter { cells[$0] }, "width \(width)")
+        }
+    }
+
+    func testTranslationWrapsAround() {
+        for width in widths {
+            let height = 6
+            let (board, cells) = makeBitboard(width: width, height: height, density: 0.3, seed: UInt64(width) &+ 2)
+            let translated = board.translated(dx: 3, dy: -2)
+            for y in 0..<height {
+                for x in 0..<width {
+                    let source = ((y + 2) % height) * width + ((x - 3) % width + width) % width
+                    XCTAssertEqual(translated[x, y], cells[source], "width \(width) at (\(x), \(y))")
+                }
+            }
+        }
+    }
+
+    // MARK: - Benchmarks
+
+    private func measureNeighbourCounts(width: Int, height: Int, iterations: Int, scalar: Bool) {
+        let (board, cells) = makeBitboard(width: width, height: height, density: 0.2, seed: 42)
+        let options = XCTMeasureOptions()
+        options.iterationCount = iterations
+        measure(options: options) {
+            if scalar {
+                _ = scalarNeighbourCounts(cells, width: width, height: height)
+            } else {
+                _ = board.neighbourCounts()
+            }
+        }
+    }
+
+    func testScalarNeighbourCountsPerformance99() {
+        measureNeighbourCounts(width: 99, height: 99, iterations: 10, scalar: true)
+    }
+
+    func testKernelNeighbourCountsPerformance99() {
+        measureNeighbourCounts(width: 99, height: 99, iterations: 10, scalar: false)
+    }
+
+    func testScalarNeighbourCountsPerformance4096() {
+        measureNeighbourCounts(width: 4096, height: 4096, iterations: 3, scalar: true)
+    }
+
+    func testKernelNeighbourCountsPerformance4096() {
+        measureNeighbourCounts(width: 4096, height: 4096, iterations: 3, scalar: false)
+    }
+}
@@ -0,0 +1,66 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import XCTest
+
+@testable import SweepMines
+
+final class BoardComplexityTests: XCTestCase {
+
+    /// Counts the 3BV with a flood fill from every opening.
+    private func floodFillThreeBV(mines: Bitboard, numberOfMinesAround: [UInt8]) -> (threeBV: Int, numberOfOpenings: Int) {
+        let width = mines.width
+        let height = mines.height
+        var isMarked = Array(repeating: false, count: width * height)
+        var numberOfOpenings = 0
+        var threeBV = 0
+
+        for index in 0..<(width * height) where !mines[index] && numberOfMinesAround[index] == 0 && !isMarked[index] {
+            numberOfOpenings += 1
+            var stack = [index]
+            isMarked[index] = true
+            while let index = stack.popLast() {
+                if numberOfMinesAround[index] != 0 {
+                    continue
+                }
+                let x = index % width
+                let y = index / width
+                for ny in max(0, y - 1)...min(height - 1, y + 1) {
+                    for nx in max(0, x - 1)...min(width - 1, x + 1) where !isMarked[ny * width + nx] {
+                        isMarked[ny * width + nx] = true
+                        stack.append(ny * width + nx)
+                    }
+                }
+            }
+        }
+        threeBV += numberOfOpenings
+        for index in 0..<(width * height) where !mines[index] && !isMarked[index] {
+            threeBV += 1
+        }
+        return (threeBV, numberOfOpenings)
+    }
+
+    func testMatchesFloodFill() {
+        for (width, height, numberOfMines) in [(9, 9, 10), (16, 16, 40), (30, 16, 99), (65, 20, 200)] {
+            var scratch = BoardComplexity.Scratch(width: width, height: height)
+            for seed: UInt64 in 0..<50 {
+                let mines = makeLayout(width: width, height: height, numberOfMines: numberOfMines, seed: seed).mines
+                let numberOfMinesAround = mines.neighbourCounts()
+                let expected = floodFillThreeBV(mines: mines, numberOfMinesAround: numberOfMinesAround)
+
+                let complexity = BoardComplexity(mines: mines, numberOfMinesAround: numberOfMinesAround)
+                XCTAssertEqual(complexity.threeBV, expected.threeBV)
+                XCTAssertEqual(complexity.numberOfOpenings, expected.numberOfOpenings)
+
+                // Reused buffers must not carry anything over from the previous layout.
+                scratch.analyse(mines: mines, numberOfMinesAround: numberOfMinesAround)
+                XCTAssertEqual(scratch.threeBV, complexity.threeBV)
+                XCTAssertEqual(scratch.numberOfOpenings, complexity.numberOfOpenings)
+                XCTAssertEqual(scratch.labels, complexity.openings)
+                XCTAssertEqual(scratch.isolatedNumbers, complexity.isolatedNumbers)
+            }
+        }
+    }
+}
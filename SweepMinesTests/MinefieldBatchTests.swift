@@ -0,0 +1,140 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import XCTest
+
+@testable import SweepMines
+
+final class MinefieldBatchTests: XCTestCase {
+
+    func testBoardsDependOnlyOnSeedAndIndex() {
+        let small = MinefieldBatch(width: 30, height: 16, numberOfMines: 99, count: 7, seed: 42)
+        let large = MinefieldBatch(width: 30, height: 16, numberOfMines: 99, count: 300, seed: 42)
+        for board in 0..<small.count {
+            XCTAssertEqual(small.mines(at: board), large.mines(at: board))
+            XCTAssertEqual(small.threeBV[board], large.threeBV[board])
+            XCTAssertEqual(small.numberOfOpenings[board], large.numberOfOpenings[board])
+            XCTAssertEqual(small.isSolvable[board], large.isSolvable[board])
+        }
+    }
+
+    func testConsecutiveSeedsShareNoBoards() {
+        let first = MinefieldBatch(width: 16, height: 16, numberOfMines: 40, count: 500, seed: 1)
+        let second = MinefieldBatch(width: 16, height: 16, numberOfMines: 40, count: 500, seed: 2)
+        let firstBoards = Set((0..<first.count).map { first.mines(at: $0).withUnsafeWords { Array($0) } })
+        for board in 0..<second.count {
+            XCTAssertFalse(firstBoards.contains(second.mines(at: board).withUnsafeWords { Array($0) }), "board \(board)")
+        }
+    }
+
+    private func makeBitboard(width: Int, height: Int, mines: [(x: Int, y: Int)]) -> Bitboard {
+        var board = Bitboard(width: width, height: height)
+        for (x, y) in mines {
+            board[x, y] = true
+        }
+        return board
+    }
+
+    func testSolvableBySingleNumbers() {
+        // . . * .
+        // . . * .
+        // o . . .
+        // The first click only opens the left half, and the numbers next to the wall of mines
+        // show that the right column is safe.
+        let mines = makeBitboard(width: 4, height: 3, mines: [(2, 0), (2, 1)])
+        XCTAssertTrue(MinefieldBatch.isSolvable(mines, firstClick: .init(x: 0, y: 2)))
+    }
+
+    func testFiftyFiftyIsNotSolvable() {
+        // ? ?
+        // 1 1
+        // o .
+        // Both numbers see the same two covered locations, so either one could hold the mine.
+        for mine in [(x: 0, y: 0), (x: 1, y: 0)] {
+            let mines = makeBitboard(width: 2, height: 3, mines: [mine])
+            XCTAssertFalse(MinefieldBatch.isSolvable(mines, firstClick: .init(x: 0, y: 2)))
+        }
+    }
+
+    func testWrittenStatisticsReadBack() throws {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer {
+            try? FileManager.default.removeItem(at: url)
+        }
+
+        let batches = [
+            MinefieldBatch(width: 9, height: 9, numberOfMines: 10, count: 13, seed: 3),
+            MinefieldBatch(width: 9, height: 9, numberOfMines: 10, count: 8, seed: 4),
+        ]
+        let writer = try BatchStatisticsWriter(url: url, width: 9, height: 9, numberOfMines: 10)
+        for batch in batches {
+            try writer.append(batch)
+        }
+        XCTAssertThrowsError(try writer.append(MinefieldBatch(width: 9, height: 8, numberOfMines: 10, count: 1, seed: 5)))
+        try writer.close()
+
+        let data = try Data(contentsOf: url)
+        XCTAssertEqual(Array(data.prefix(4)), BatchStatisticsWriter.magic)
+        var offset = 4
+        XCTAssertEqual(data.readLittleEndian(UInt32.self, at: &offset), BatchStatisticsWriter.version)
+        XCTAssertEqual(data.readLittleEndian(UInt32.self, at: &offset), 9)
+        XCTAssertEqual(data.readLittleEndian(UInt32.self, at: &offset), 9)
+        XCTAssertEqual(data.readLittleEndian(UInt32.self, at: &offset), 10)
+
+        for batch in batches {
+            XCTAssertEqual(data.readLittleEndian(UInt32.self, at: &offset), UInt32(batch.count))
+            XCTAssertEqual(data.readLittleEndian(UInt64.self, at: &offset), batch.seed)
+            for board in 0..<batch.count {
+                XCTAssertEqual(data.readLittleEndian(UInt32.self, at: &offset), batch.threeBV[board])
+            }
+            for board in 0..<batch.count {
+                XCTAssertEqual(data.readLittleEndian(UInt32.self, at: &offset), batch.numberOfOpenings[board])
+            }
+            let bytes = data[(data.startIndex + offset)..<(data.startIndex + offset + (batch.count + 7) / 8)]
+            for board in 0..<batch.count {
+                let byte = bytes[bytes.startIndex + board / 8]
+                XCTAssertEqual(byte & (1 << UInt8(board % 8)) != 0, batch.isSolvable[board], "board \(board)")
+            }
+            // Padding bits past the last board stay clear.
+            if batch.count % 8 != 0 {
+                XCTAssertEqual(bytes.last! >> UInt8(batch.count % 8), 0)
+            }
+            offset += bytes.count
+        }
+        XCTAssertEqual(offset, data.count)
+    }
+
+    func testStatisticsMatchBoardComplexity() {
+        let firstClick = Minefield.Position(x: 3, y: 4)
+        let batch = MinefieldBatch(width: 30, height: 16, numberOfMines: 99, count: 200, seed: 7, firstClick: firstClick)
+        for board in 0..<batch.count {
+            let mines = batch.mines(at: board)
+            XCTAssertEqual(mines.nonzeroBitCount, 99)
+            for y in 3...5 {
+                for x in 2...4 {
+                    XCTAssertFalse(mines[x, y])
+                }
+            }
+
+            let complexity = BoardComplexity(mines: mines, numberOfMinesAround: mines.neighbourCounts())
+            XCTAssertEqual(Int(batch.threeBV[board]), complexity.threeBV)
+            XCTAssertEqual(Int(batch.numberOfOpenings[board]), complexity.numberOfOpenings)
+        }
+    }
+
+    func testLargeBoardStatisticsDoNotSaturate() {
+        // At expert density, a board this size has a 3BV well past `UInt16.max`.
+        let batch = MinefieldBatch(width: 1024, height: 1024, numberOfMines: 216_000, count: 1, seed: 1)
+        XCTAssertGreaterThan(batch.threeBV[0], UInt32(UInt16.max))
+    }
+
+    func testExpertGenerationPerformance() {
+        let options = XCTMeasureOptions()
+        options.iterationCount = 5
+        measure(metrics: [XCTClockMetric()], options: options) {
+            _ = MinefieldBatch(width: 30, height: 16, numberOfMines: 99, count: 10_000, seed: 1)
+        }
+    }
+}
@@ -0,0 +1,196 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import Combine
+import XCTest
+
+@testable import SweepMines
+
+final class MinefieldEngineTests: XCTestCase {
+
+    private let width = 30
+    private let height = 16
+    private let numberOfMines = 40
+
+    private func makeMinefield(seed: UInt64) -> Minefield {
+        .init(
+            width: width,
+            height: height,
+            numberOfMines: numberOfMines,
+            layout: makeLayout(width: width, height: height, numberOfMines: numberOfMines, seed: seed)
+        )
+    }
+
+    /// Enqueues the moves from several threads at once, and returns the moves in the order the
+    /// engine accepted them along with the mirror built from the published updates.
+    private func runEngine(
+        seed: UInt64,
+        numberOfProducers: Int,
+        movesPerProducer: Int
+    ) -> (moves: [MinefieldEngine.Move], mirror: Minefield) {
+        let mirror = makeMinefield(seed: seed)
+        let deliveryQueue = DispatchQueue(label: "MinefieldEngineTests.delivery")
+        let engine = MinefieldEngine(minefield: mirror, deliveryQueue: deliveryQueue)
+        let total = MinefieldEngine.MoveID(numberOfProducers * movesPerProducer)
+
+        let finished = expectation(description: "All moves applied")
+        var lastMoveID: MinefieldEngine.MoveID = 0
+        let cancellable = engine.updates.sink { update in
+            // Runs on `deliveryQueue`.
+            XCTAssertGreaterThan(update.lastMoveID, lastMoveID)
+            lastMoveID = update.lastMoveID
+            mirror.apply(update.changes)
+            if update.lastMoveID == total {
+                finished.fulfill()
+            }
+        }
+
+        let lock = NSLock()
+        var accepted: [(id: MinefieldEngine.MoveID, move: MinefieldEngine.Move)] = []
+        DispatchQueue.concurrentPerform(iterations: numberOfProducers) { producer in
+            let moves = makeMoves(width: width, height: height, count: movesPerProducer, seed: seed &+ UInt64(producer) &* 7919)
+            for (index, move) in moves.enumerated() {
+                // Hold the lock across enqueueing so that recorded pairs stay consistent.
+                lock.lock()
+                let id = engine.enqueue(move)
+                accepted.append((id, move))
+                lock.unlock()
+                if index % 16 == 0 {
+                    // Let the engine drain now and then, so batches vary in size.
+                    usleep(50)
+                }
+            }
+        }
+
+        wait(for: [finished], timeout: 30)
+        cancellable.cancel()
+
+        let moves = accepted.sorted { $0.id < $1.id }.map(\.move)
+        return (moves, deliveryQueue.sync { mirror })
+    }
+
+    func testConcurrentMovesMatchSynchronousReplay() {
+        for seed: UInt64 in 1...20 {
+            let (moves, mirror) = runEngine(seed: seed, numberOfProducers: 4, movesPerProducer: 250)
+
+            let expected = makeMinefield(seed: seed)
+            replay(moves, on: expected)
+            XCTAssertSameState(mirror, expected)
+        }
+    }
+
+    func testSingleProducerMatchesSynchronousReplay() {
+        for seed: UInt64 in 100...120 {
+            let (moves, mirror) = runEngine(seed: seed, numberOfProducers: 1, movesPerProducer: 400)
+
+            let expected = makeMinefield(seed: seed)
+            replay(moves, on: expected)
+            XCTAssertSameState(mirror, expected)
+        }
+    }
+
+    func testChangeSetsKeepMirrorIdentical() {
+        for seed: UInt64 in 200...220 {
+            let source = makeMinefield(seed: seed)
+            let mirror = source.copy()
+            var generator = SplitMix64(seed: seed)
+            let moves = makeMoves(width: width, height: height, count: 600, seed: seed)
+
+            // Apply change sets after batches of random size.
+            var start = 0
+            while start < moves.count {
+                let end = min(moves.count, start + Int.random(in: 1...20, using: &generator))
+                replay(Array(moves[start..<end]), on: source)
+                mirror.apply(source.takeChanges())
+                XCTAssertSameState(mirror, source)
+                start = end
+            }
+        }
+    }
+
+    /// Mirrors the board view controller: flag changes are shown on the mirror right away, and
+    /// put back on top of every update until the engine has applied them.
+    func testPendingFlagsAreNotReverted() {
+        for seed: UInt64 in 300...320 {
+            let mirror = makeMinefield(seed: seed)
+            let deliveryQueue = DispatchQueue(label: "MinefieldEngineTests.delivery")
+            let engine = MinefieldEngine(minefield: mirror, deliveryQueue: deliveryQueue)
+            var generator = SplitMix64(seed: seed)
+
+            var pendingFlags = MinefieldEngine.PendingFlags()
+            var shownFlags: [Minefield.Position: (flag: Minefield.Flag, moveID: MinefieldEngine.MoveID)] = [:]
+            var moves: [MinefieldEngine.Move] = []
+            var lastMoveID: MinefieldEngine.MoveID = 0
+            var appliedMoveID: MinefieldEngine.MoveID = 0
+
+            let finished = expectation(description: "All moves applied")
+            let cancellable = engine.updates.sink { update in
+                pendingFlags.apply(update, to: mirror)
+                appliedMoveID = update.lastMoveID
+                for (position, shown) in shownFlags where shown.moveID > update.lastMoveID {
+                    let location = mirror.location(at: position)
+                    XCTAssertTrue(location.isCleared || location.flag == shown.flag, "seed \(seed) at \(position)")
+                }
+                if update.lastMoveID == lastMoveID {
+                    finished.fulfill()
+                }
+            }
+
+            func perform(_ move: MinefieldEngine.Move) {
+                if case .changeFlag(let flag, let position) = move {
+                    mirror.changeFlag(to: flag, at: position)
+                    let moveID = engine.enqueue(move)
+                    pendingFlags.insert(flag, at: position, moveID: moveID)
+                    shownFlags[position] = (flag, moveID)
+                } else {
+                    engine.enqueue(move)
+                }
+                moves.append(move)
+            }
+
+            func randomMove() -> MinefieldEngine.Move {
+                let position = Minefield.Position(
+                    x: Int.random(in: 0..<width, using: &generator),
+                    y: Int.random(in: 0..<height, using: &generator)
+                )
+                if Int.random(in: 0..<4, using: &generator) == 0 {
+                    return .clear(position)
+                }
+                return .changeFlag(mirror.location(at: position).flag.next(), position)
+            }
+
+            // Hold back deliveries so that the first clear is delivered after the flag changes
+            // queued behind it, then keep going while updates arrive.
+            deliveryQueue.suspend()
+            perform(.clear(.init(x: width / 2, y: height / 2)))
+            for _ in 0..<40 {
+                perform(randomMove())
+            }
+            deliveryQueue.resume()
+            for _ in 0..<200 {
+                deliveryQueue.sync {
+                    perform(randomMove())
+                }
+                usleep(20)
+            }
+            deliveryQueue.sync {
+                lastMoveID = MinefieldEngine.MoveID(moves.count)
+                if appliedMoveID == lastMoveID {
+                    finished.fulfill()
+                }
+            }
+
+            wait(for: [finished], timeout: 10)
+            cancellable.cancel()
+
+            let expected = makeMinefield(seed: seed)
+            replay(moves, on: expected)
+            deliveryQueue.sync {
+                XCTAssertTrue(pendingFlags.isEmpty)
+                XCTAssertSameState(mirror, expected)
+            }
+        }
+    }
+}
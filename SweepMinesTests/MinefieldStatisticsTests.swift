@@ -0,0 +1,85 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import Combine
+import XCTest
+
+@testable import SweepMines
+
+final class MinefieldStatisticsTests: XCTestCase {
+
+    private let width = 16
+    private let height = 16
+    private let numberOfMines = 40
+
+    private func makeMinefield(seed: UInt64) -> Minefield {
+        .init(
+            width: width,
+            height: height,
+            numberOfMines: numberOfMines,
+            layout: makeLayout(width: width, height: height, numberOfMines: numberOfMines, seed: seed)
+        )
+    }
+
+    /// Runs the moves through an engine, pausing after every `pause` moves so that the engine
+    /// drains them in differently sized batches.
+    private func statisticsThroughEngine(_ moves: [MinefieldEngine.Move], seed: UInt64, pause: Int) -> Minefield.Statistics {
+        let deliveryQueue = DispatchQueue(label: "MinefieldStatisticsTests.delivery")
+        let engine = MinefieldEngine(minefield: makeMinefield(seed: seed), deliveryQueue: deliveryQueue)
+
+        let finished = expectation(description: "All moves applied")
+        var statistics = Minefield.Statistics()
+        let cancellable = engine.updates.sink { update in
+            if update.lastMoveID == MinefieldEngine.MoveID(moves.count) {
+                statistics = update.changes.statistics
+                finished.fulfill()
+            }
+        }
+
+        for (index, move) in moves.enumerated() {
+            engine.enqueue(move)
+            if index % pause == 0 {
+                usleep(100)
+            }
+        }
+
+        wait(for: [finished], timeout: 10)
+        cancellable.cancel()
+        return deliveryQueue.sync { statistics }
+    }
+
+    func testReplayGivesSameStatistics() {
+        for seed: UInt64 in 1...50 {
+            // Repeated clears of the same cells are common while the engine is busy.
+            let moves = makeMoves(width: width, height: height, count: 80, seed: seed).flatMap { [$0, $0] }
+
+            let expected = makeMinefield(seed: seed)
+            replay(moves, on: expected)
+            XCTAssertGreaterThan(expected.statistics.numberOfClicks, 0)
+
+            let again = makeMinefield(seed: seed)
+            replay(moves, on: again)
+            XCTAssertEqual(again.statistics, expected.statistics)
+
+            for pause in [1, 3, 7, moves.count] {
+                XCTAssertEqual(statisticsThroughEngine(moves, seed: seed, pause: pause), expected.statistics, "seed \(seed), pause \(pause)")
+            }
+        }
+    }
+
+    func testThreeBVIsSolvedOnWin() {
+        let minefield = makeMinefield(seed: 7)
+        minefield.clearMine(at: .init(x: width / 2, y: height / 2))
+        for y in 0..<height {
+            for x in 0..<width where !minefield.hasMineAt(x: x, y: y) {
+                minefield.clearMine(at: .init(x: x, y: y))
+            }
+        }
+
+        XCTAssertTrue(minefield.isCompleted)
+        XCTAssertEqual(minefield.statistics.solvedThreeBV, minefield.statistics.threeBV)
+        XCTAssertLessThanOrEqual(minefield.statistics.threeBV, minefield.statistics.numberOfClicks)
+    }
+}
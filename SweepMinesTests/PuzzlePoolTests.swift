@@ -0,0 +1,98 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import XCTest
+
+@testable import SweepMines
+
+final class PuzzlePoolTests: XCTestCase {
+
+    private func makeLayouts(for key: PuzzlePool.Key, count: Int) -> [Bitboard] {
+        (0..<count).map { seed in
+            makeLayout(width: key.width, height: key.height, numberOfMines: key.numberOfMines, seed: UInt64(seed)).mines
+        }
+    }
+
+    func testKeyRejectsBoardsWithoutSafeArea() {
+        XCTAssertNil(PuzzlePool.Key(width: 2, height: 9, numberOfMines: 1))
+        XCTAssertNil(PuzzlePool.Key(width: 9, height: 2, numberOfMines: 1))
+        XCTAssertNil(PuzzlePool.Key(width: 9, height: 9, numberOfMines: 73))
+        XCTAssertNotNil(PuzzlePool.Key(width: 9, height: 9, numberOfMines: 72))
+        XCTAssertNotNil(PuzzlePool.Key(width: 200, height: 150, numberOfMines: 6000))
+    }
+
+    func testRoundTrip() {
+        // 81 and 91 locations leave the last byte of each layout partially used.
+        for (width, height, numberOfMines) in [(9, 9, 10), (13, 7, 20), (16, 16, 40), (65, 3, 30)] {
+            let key = PuzzlePool.Key(width: width, height: height, numberOfMines: numberOfMines)!
+            let layouts = makeLayouts(for: key, count: 5)
+            let data = PuzzlePool.encode(layouts, for: key)
+
+            XCTAssertEqual(data.count, 24 + layouts.count * ((width * height + 7) / 8))
+            XCTAssertEqual(PuzzlePool.decode(data, for: key), layouts)
+        }
+    }
+
+    func testRejectsOtherVersions() {
+        let key = PuzzlePool.Key(width: 9, height: 9, numberOfMines: 10)!
+        var data = PuzzlePool.encode(makeLayouts(for: key, count: 3), for: key)
+        data.replaceSubrange(4..<8, with: [1, 0, 0, 0])
+        XCTAssertEqual(PuzzlePool.decode(data, for: key), [])
+    }
+
+    func testRejectsOtherBoardSizes() {
+        let key = PuzzlePool.Key(width: 9, height: 9, numberOfMines: 10)!
+        let data = PuzzlePool.encode(makeLayouts(for: key, count: 3), for: key)
+        XCTAssertEqual(PuzzlePool.decode(data, for: PuzzlePool.Key(width: 9, height: 9, numberOfMines: 11)!), [])
+        XCTAssertEqual(PuzzlePool.decode(data, for: PuzzlePool.Key(width: 9, height: 10, numberOfMines: 10)!), [])
+    }
+
+    func testDropsTruncatedLayouts() {
+        let key = PuzzlePool.Key(width: 13, height: 7, numberOfMines: 20)!
+        let layouts = makeLayouts(for: key, count: 4)
+        let data = PuzzlePool.encode(layouts, for: key)
+
+        XCTAssertEqual(PuzzlePool.decode(data.dropLast(1), for: key), Array(layouts.prefix(3)))
+        XCTAssertEqual(PuzzlePool.decode(data.prefix(20), for: key), [])
+    }
+
+    func testDropsLayoutsWithWrongNumberOfMines() {
+        let key = PuzzlePool.Key(width: 9, height: 9, numberOfMines: 10)!
+        let layouts = makeLayouts(for: key, count: 3)
+        var data = PuzzlePool.encode(layouts, for: key)
+
+        // Add a mine to the second layout.
+        let bytesPerLayout = (9 * 9 + 7) / 8
+        let index = (0..<81).first { !layouts[1][$0] }!
+        data[24 + bytesPerLayout + index / 8] |= 1 << UInt8(index % 8)
+        XCTAssertEqual(PuzzlePool.decode(data, for: key), [layouts[0], layouts[2]])
+    }
+
+    func testTranslatedLayoutKeepsFirstClickSafe() {
+        let width = 16
+        let height = 12
+        let numberOfMines = 60
+        let positions = [
+            (0, 0), (width - 1, 0), (0, height - 1), (width - 1, height - 1),
+            (width / 2, 0), (0, height / 2), (width - 1, height / 2), (width / 2, height - 1),
+            (1, 1), (width - 2, height - 2),
+        ].map { Minefield.Position(x: $0.0, y: $0.1) }
+
+        for seed: UInt64 in 0..<20 {
+            let layout = makeLayout(width: width, height: height, numberOfMines: numberOfMines, seed: seed)
+            for position in positions {
+                let minefield = Minefield(width: width, height: height, numberOfMines: numberOfMines, layout: layout)
+                minefield.clearMine(at: position)
+
+                XCTAssertFalse(minefield.isExploded, "seed \(seed) at \(position)")
+                XCTAssertEqual(minefield.locations.filter(\.hasMine).count, numberOfMines)
+                XCTAssertEqual(minefield.location(at: position).numberOfMinesAround, 0, "seed \(seed) at \(position)")
+                for neighbour in minefield.neighbour(of: position) {
+                    XCTAssertFalse(minefield.location(at: neighbour).hasMine, "seed \(seed) at \(neighbour)")
+                }
+            }
+        }
+    }
+}
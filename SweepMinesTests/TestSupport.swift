@@ -0,0 +1,67 @@
+//
+//  Created by ktiays on 2026/10/19.
+//  Copyright (c) 2026 ktiays. All rights reserved.
+//
+
+import XCTest
+
+@testable import SweepMines
+
+/// Returns a reproducible layout whose 3×3 area around the centre contains no mines.
+func makeLayout(width: Int, height: Int, numberOfMines: Int, seed: UInt64) -> Minefield.Layout {
+    var generator = SplitMix64(seed: seed)
+    let anchor = Minefield.Position(x: width / 2, y: height / 2)
+    var candidates = (0..<(width * height)).filter { index in
+        abs(index % width - anchor.x) > 1 || abs(index / width - anchor.y) > 1
+    }
+    candidates.shuffle(using: &generator)
+
+    var mines = Bitboard(width: width, height: height)
+    for index in candidates.prefix(numberOfMines) {
+        mines[index] = true
+    }
+    return .init(mines: mines, anchor: anchor)
+}
+
+/// Returns a reproducible sequence of taps, chords and flag changes.
+func makeMoves(width: Int, height: Int, count: Int, seed: UInt64) -> [MinefieldEngine.Move] {
+    var generator = SplitMix64(seed: seed)
+    return (0..<count).map { _ in
+        let position = Minefield.Position(
+            x: Int.random(in: 0..<width, using: &generator),
+            y: Int.random(in: 0..<height, using: &generator)
+        )
+        switch Int.random(in: 0..<10, using: &generator) {
+        case 0..<6:
+            return .clear(position)
+        case 6..<8:
+            return .multiRelease(position)
+        default:
+            return .changeFlag(Minefield.Flag.allCases.randomElement(using: &generator)!, position)
+        }
+    }
+}
+
+/// Applies the moves one by one on the calling thread.
+func replay(_ moves: [MinefieldEngine.Move], on minefield: Minefield) {
+    for move in moves {
+        switch move {
+        case .clear(let position):
+            minefield.clearMine(at: position)
+        case .multiRelease(let position):
+            minefield.multiRelease(at: position)
+        case .changeFlag(let flag, let position):
+            minefield.changeFlag(to: flag, at: position)
+        }
+    }
+}
+
+func XCTAssertSameState(_ lhs: Minefield, _ rhs: Minefield, file: StaticString = #filePath, line: UInt = #line) {
+    XCTAssertEqual(lhs.locations, rhs.locations, "locations", file: file, line: line)
+    XCTAssertEqual(lhs.numberOfCleared, rhs.numberOfCleared, "numberOfCleared", file: file, line: line)
+    XCTAssertEqual(lhs.numberOfFlagged, rhs.numberOfFlagged, "numberOfFlagged", file: file, line: line)
+    XCTAssertEqual(lhs.isPlacedMines, rhs.isPlacedMines, "isPlacedMines", file: file, line: line)
+    XCTAssertEqual(lhs.isExploded, rhs.isExploded, "isExploded", file: file, line: line)
+    XCTAssertEqual(lhs.isCompleted, rhs.isCompleted, "isCompleted", file: file, line: line)
+    XCTAssertEqual(lhs.statistics, rhs.statistics, "statistics", file: file, line: line)
+}